@@ -0,0 +1,73 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+#include "gpio_chip.hpp"
+#include "gpio_chip_fake.hpp"
+#include "gpio_pin.hpp"
+#include "mcu_type.hpp"
+
+namespace {
+
+constexpr int iterations = 100000;
+
+/**
+ * @brief Toggle every line of a port and report syscalls and time.
+ *
+ * @param batched true to write the whole port and commit once per step,
+ *                false to commit after every single pin write.
+ */
+template <ss::McuType T>
+void toggleAll(const char* name, std::size_t numLines, bool batched)
+{
+    ss::GPIO_chip_fake_io io("/dev/gpiochip0", 64);
+    ss::GPIO_chip chip(io, "/dev/gpiochip0");
+
+    std::uint32_t offsets[64];
+    for(std::size_t i = 0; i < numLines; ++i)
+    {
+        offsets[i] = (std::uint32_t)i;
+    }
+    ss::GPIO_chip_port<T> port(chip, std::span<const std::uint32_t>(offsets, numLines));
+    for(std::size_t bit = 0; bit < numLines; ++bit)
+    {
+        port.setDirection((T)bit, true);
+    }
+    port.commit();
+    io.resetCounters();
+
+    const auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < iterations; ++i)
+    {
+        const bool high = (i & 1) == 0;
+        if(batched)
+        {
+            port.setBits(port.lines(), high ? port.lines() : 0);
+            port.commit();
+        }
+        else
+        {
+            for(std::size_t bit = 0; bit < numLines; ++bit)
+            {
+                port.setBit((T)bit, high);
+                port.commit();
+            }
+        }
+    }
+    const auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << name << (batched ? " batched" : " per-pin")
+              << "  syscalls/step=" << (double)io.syscallCount() / iterations
+              << " us/step=" << elapsed / iterations
+              << "\n";
+}
+
+} // namespace
+
+int main()
+{
+    toggleAll<ss::AVR>("AVR  8 lines", 8, false);
+    toggleAll<ss::AVR>("AVR  8 lines", 8, true);
+    toggleAll<ss::ARM>("ARM 32 lines", 32, false);
+    toggleAll<ss::ARM>("ARM 32 lines", 32, true);
+}
@@ -0,0 +1,69 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "gpio_sim.hpp"
+#include "mcu_type.hpp"
+
+namespace {
+
+constexpr std::size_t numPorts = 8192;
+constexpr std::uint64_t numTicks = 200;
+
+/**
+ * @brief Simulate a ring of ports where each port mirrors its byte of inputs
+ *        to its outputs and wires them to the next port.
+ * @return Port updates per second.
+ */
+double simulate(std::size_t threads)
+{
+    ss::GPIO_sim<ss::ARM> sim(threads);
+    for(std::size_t i = 0; i < numPorts; ++i)
+    {
+        sim.addPort();
+        for(ss::ARM bit = 0; bit < 8; ++bit)
+        {
+            sim.port(i).setDirection(bit, true);
+        }
+    }
+    for(std::size_t i = 0; i < numPorts; ++i)
+    {
+        for(ss::ARM bit = 0; bit < 8; ++bit)
+        {
+            sim.connect(i, bit, (i + 1) % numPorts, bit + 8);
+        }
+        sim.addTask(i, [](ss::GPIO_sim<ss::ARM>::Port& port)
+        {
+            const ss::ARM in = port.readBits(0xFF00) >> 8;
+            port.queueBits(0xFF, (ss::ARM)(in + 1));
+        });
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    sim.run(numTicks);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return (double)(numPorts * numTicks) / seconds;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::size_t maxThreads = std::thread::hardware_concurrency() != 0 ? std::thread::hardware_concurrency() : 1;
+    if(argc > 1)
+    {
+        maxThreads = std::stoul(argv[1]);
+    }
+    const double base = simulate(1);
+    std::cout << numPorts << " ports, " << numTicks << " ticks\n";
+    for(std::size_t threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        const double rate = threads == 1 ? base : simulate(threads);
+        std::cout << "threads=" << threads
+                  << "  port-ticks/s=" << rate
+                  << "  speedup=" << rate / base
+                  << "\n";
+    }
+}
@@ -0,0 +1,372 @@
+/**
+ * @file gpio_chip.hpp
+ * @brief Linux GPIO character-device (gpiochip v2 uAPI) backend.
+ *
+ * @details
+ * This header lets the regular @ref ss::GPIO_pin / @ref ss::GPIO_port code drive
+ * real lines on a Linux board through @c /dev/gpiochipN.
+ *
+ * @ref ss::GPIO_chip_port is a @ref ss::GPIO_port whose DDR/PORT/PIN registers are
+ * shadow copies kept in memory. Pin and port operations only touch the shadows;
+ * @ref ss::GPIO_chip_port::commit() pushes the accumulated changes to the kernel and
+ * @ref ss::GPIO_chip_port::refresh() pulls input levels back. All lines of a port are
+ * held by one cached line request, so a port-wide write costs a single
+ * @c GPIO_V2_LINE_SET_VALUES_IOCTL regardless of how many bits changed.
+ *
+ * Every system call goes through @ref ss::GPIO_chip_io, which can be replaced
+ * (e.g. by @ref ss::GPIO_chip_fake_io) to run without hardware and to count calls.
+ *
+ * @note Linux only.
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <span>
+#include <initializer_list>
+#include <type_traits>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+
+#include "mcu_type.hpp"
+#include "gpio_port.hpp"
+
+namespace ss{
+
+    /**
+     * @class GPIO_chip_io
+     * @brief Injectable system-call layer used by the gpiochip backend.
+     *
+     * @details
+     * Public calls are counted and forwarded to the protected virtual hooks,
+     * so derived classes only implement the actual operation.
+     */
+    class GPIO_chip_io
+    {
+        std::size_t opens = 0;   /**< Number of open() calls. */
+        std::size_t ioctls = 0;  /**< Number of ioctl() calls. */
+        std::size_t closes = 0;  /**< Number of close() calls. */
+
+        protected:
+            virtual int doOpen(const char* path) = 0;
+            virtual int doIoctl(int fd, unsigned long request, void* arg) = 0;
+            virtual int doClose(int fd) = 0;
+
+        public:
+            virtual ~GPIO_chip_io(){};
+
+            /** @brief Open a gpiochip device, returns fd or -1 with errno set. */
+            int open(const char* path)
+            {
+                ++opens;
+                return doOpen(path);
+            }
+
+            /** @brief Issue an ioctl, returns -1 with errno set on failure. */
+            int ioctl(int fd, unsigned long request, void* arg)
+            {
+                ++ioctls;
+                return doIoctl(fd, request, arg);
+            }
+
+            /** @brief Close a chip or line request fd. */
+            int close(int fd)
+            {
+                ++closes;
+                return doClose(fd);
+            }
+
+            /** @brief Number of ioctl() calls issued so far. */
+            std::size_t ioctlCount() const { return ioctls; }
+
+            /** @brief Number of all system calls (open/ioctl/close) issued so far. */
+            std::size_t syscallCount() const { return opens + ioctls + closes; }
+
+            /** @brief Reset all call counters to zero. */
+            void resetCounters()
+            {
+                opens = 0;
+                ioctls = 0;
+                closes = 0;
+            }
+    };
+
+    /**
+     * @class GPIO_chip_sys_io
+     * @brief @ref GPIO_chip_io implementation calling the real kernel interface.
+     */
+    class GPIO_chip_sys_io final : public GPIO_chip_io
+    {
+        protected:
+            int doOpen(const char* path) override
+            {
+                return ::open(path, O_RDWR | O_CLOEXEC);
+            }
+
+            int doIoctl(int fd, unsigned long request, void* arg) override
+            {
+                return ::ioctl(fd, request, arg);
+            }
+
+            int doClose(int fd) override
+            {
+                return ::close(fd);
+            }
+    };
+
+    /**
+     * @class GPIO_chip
+     * @brief Open handle to a single gpiochip device.
+     *
+     * @details
+     * Several @ref GPIO_chip_port instances may share one chip.
+     */
+    class GPIO_chip
+    {
+        GPIO_chip_io& io;   /**< System-call layer. */
+        int fd;             /**< Chip file descriptor. */
+
+        public:
+            /**
+             * @brief Open a gpiochip device.
+             *
+             * @param pio  System-call layer used for this chip and its ports.
+             * @param path Device path, e.g. "/dev/gpiochip0".
+             *
+             * @throws std::system_error If the device cannot be opened.
+             */
+            GPIO_chip(GPIO_chip_io& pio, const char* path) : io(pio), fd(pio.open(path))
+            {
+                if(fd < 0)
+                {
+                    throw std::system_error(errno, std::generic_category(), "Cannot open gpiochip");
+                }
+            }
+
+            ~GPIO_chip()
+            {
+                io.close(fd);
+            }
+
+            GPIO_chip(const GPIO_chip&) = delete;
+            GPIO_chip& operator=(const GPIO_chip&) = delete;
+
+            /** @brief System-call layer bound to this chip. */
+            GPIO_chip_io& ioLayer() const { return io; }
+
+            /** @brief Chip file descriptor. */
+            int handle() const { return fd; }
+    };
+
+    /**
+     * @brief GPIO port backed by lines of a Linux gpiochip.
+     *
+     * @tparam T MCU register type constrained by @ref ss::McuType.
+     *
+     * @details
+     * Bit @c i of the port maps to the @c i-th line offset given to the constructor.
+     * Register semantics follow @ref GPIO_port: a DDR bit selects output, and a
+     * PORT bit on an input line enables the pull-up bias.
+     */
+    template<McuType T>
+    class GPIO_chip_port : private detail::GPIO_registers<std::remove_cv_t<T>>, public GPIO_port<std::remove_cv_t<T>>
+    {
+        using reg_t = std::remove_cv_t<T>;               /**< Register type without cv-qualifiers. */
+        using shadow_t = detail::GPIO_registers<reg_t>;
+
+        static constexpr std::size_t maxLines = sizeof(reg_t) * 8 < GPIO_V2_LINES_MAX ? sizeof(reg_t) * 8 : GPIO_V2_LINES_MAX;
+
+        GPIO_chip& chip;                         /**< Chip owning the lines. */
+        std::uint32_t offsets[maxLines] = {};    /**< Chip line offset for each port bit. */
+        std::size_t numLines = 0;                /**< Number of mapped lines. */
+        reg_t lineMask = 0;                      /**< Bits backed by a line. */
+        int requestFd = -1;                      /**< Cached line request, -1 until first commit. */
+        reg_t lastDdr = 0;                       /**< Output lines as last sent to the kernel. */
+        reg_t lastPull = 0;                      /**< Pull-up lines as last sent to the kernel. */
+        reg_t lastOut = 0;                       /**< Output levels as last sent to the kernel. */
+
+        void check(int result, const char* what)
+        {
+            if(result < 0)
+            {
+                throw std::system_error(errno, std::generic_category(), what);
+            }
+        }
+
+        /**
+         * @brief Build a line configuration from direction, pull-up and output masks.
+         *
+         * @details
+         * Inputs use the default flags; outputs and pulled-up inputs are
+         * overridden with attributes so the whole port fits in one config.
+         * Every line carries an explicit bias flag, because the kernel keeps
+         * the previous bias of a line whose config sets none.
+         */
+        static gpio_v2_line_config buildConfig(reg_t ddr, reg_t pull, reg_t out)
+        {
+            gpio_v2_line_config config{};
+            config.flags = GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_BIAS_DISABLED;
+
+            if(ddr != 0)
+            {
+                gpio_v2_line_config_attribute& flags = config.attrs[config.num_attrs++];
+                flags.attr.id = GPIO_V2_LINE_ATTR_ID_FLAGS;
+                flags.attr.flags = GPIO_V2_LINE_FLAG_OUTPUT | GPIO_V2_LINE_FLAG_BIAS_DISABLED;
+                flags.mask = ddr;
+
+                gpio_v2_line_config_attribute& values = config.attrs[config.num_attrs++];
+                values.attr.id = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+                values.attr.values = out;
+                values.mask = ddr;
+            }
+            if(pull != 0)
+            {
+                gpio_v2_line_config_attribute& flags = config.attrs[config.num_attrs++];
+                flags.attr.id = GPIO_V2_LINE_ATTR_ID_FLAGS;
+                flags.attr.flags = GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_BIAS_PULL_UP;
+                flags.mask = pull;
+            }
+            return config;
+        }
+
+        void requestLines(reg_t ddr, reg_t pull, reg_t out)
+        {
+            gpio_v2_line_request request{};
+            std::memcpy(request.offsets, offsets, numLines * sizeof(std::uint32_t));
+            std::strncpy(request.consumer, "ss-gpio", sizeof(request.consumer) - 1);
+            request.config = buildConfig(ddr, pull, out);
+            request.num_lines = (std::uint32_t)numLines;
+
+            check(chip.ioLayer().ioctl(chip.handle(), GPIO_V2_GET_LINE_IOCTL, &request), "GPIO_V2_GET_LINE_IOCTL failed");
+            requestFd = request.fd;
+        }
+
+        public:
+            /**
+             * @brief Construct a port from chip line offsets.
+             *
+             * @param pchip   Opened gpiochip.
+             * @param poffsets Line offset for each port bit, starting at bit 0.
+             *
+             * @throws std::invalid_argument If no offsets or more offsets than register bits are given.
+             *
+             * @details Lines are requested lazily on the first @ref commit().
+             */
+            GPIO_chip_port(GPIO_chip& pchip, std::span<const std::uint32_t> poffsets)
+                : GPIO_port<reg_t>(shadow_t::ddr, shadow_t::port, shadow_t::pin), chip(pchip)
+            {
+                if(poffsets.empty() || poffsets.size() > maxLines)
+                {
+                    throw std::invalid_argument("Wrong number of gpiochip lines");
+                }
+                numLines = poffsets.size();
+                for(std::size_t i = 0; i < numLines; ++i)
+                {
+                    offsets[i] = poffsets[i];
+                    lineMask |= (reg_t)((reg_t)1 << i);
+                }
+            }
+
+            /** @copydoc GPIO_chip_port(GPIO_chip&, std::span<const std::uint32_t>) */
+            GPIO_chip_port(GPIO_chip& pchip, std::initializer_list<std::uint32_t> poffsets)
+                : GPIO_chip_port(pchip, std::span<const std::uint32_t>(poffsets.begin(), poffsets.size()))
+            {
+            }
+
+            ~GPIO_chip_port()
+            {
+                if(requestFd >= 0)
+                {
+                    chip.ioLayer().close(requestFd);
+                }
+            }
+
+            GPIO_chip_port(const GPIO_chip_port&) = delete;
+            GPIO_chip_port& operator=(const GPIO_chip_port&) = delete;
+
+            /**
+             * @brief Push shadow register changes to the kernel.
+             *
+             * @details
+             * The first call requests all lines in one @c GPIO_V2_GET_LINE_IOCTL.
+             * Afterwards a direction or pull change costs one
+             * @c GPIO_V2_LINE_SET_CONFIG_IOCTL, output-only changes one
+             * @c GPIO_V2_LINE_SET_VALUES_IOCTL with the changed bits as mask,
+             * and no change costs nothing.
+             *
+             * @throws std::system_error If an ioctl fails.
+             */
+            void commit()
+            {
+                const reg_t ddr = (reg_t)(this->DDRx & lineMask);
+                const reg_t pull = (reg_t)(~this->DDRx & this->PORTx & lineMask);
+                const reg_t out = (reg_t)(this->PORTx & ddr);
+
+                if(requestFd < 0)
+                {
+                    requestLines(ddr, pull, out);
+                }
+                else if(ddr != lastDdr || pull != lastPull)
+                {
+                    gpio_v2_line_config config = buildConfig(ddr, pull, out);
+                    check(chip.ioLayer().ioctl(requestFd, GPIO_V2_LINE_SET_CONFIG_IOCTL, &config), "GPIO_V2_LINE_SET_CONFIG_IOCTL failed");
+                }
+                else if(const reg_t changed = (reg_t)((out ^ lastOut) & ddr); changed != 0)
+                {
+                    gpio_v2_line_values values{};
+                    values.mask = changed;
+                    values.bits = out;
+                    check(chip.ioLayer().ioctl(requestFd, GPIO_V2_LINE_SET_VALUES_IOCTL, &values), "GPIO_V2_LINE_SET_VALUES_IOCTL failed");
+                }
+
+                lastDdr = ddr;
+                lastPull = pull;
+                lastOut = out;
+            }
+
+            /**
+             * @brief Read levels of all input lines into the PIN shadow register.
+             *
+             * @details
+             * Costs one @c GPIO_V2_LINE_GET_VALUES_IOCTL, or nothing if the port has no inputs.
+             * Lines are requested first if @ref commit() was never called.
+             *
+             * @throws std::system_error If an ioctl fails.
+             */
+            void refresh()
+            {
+                if(requestFd < 0)
+                {
+                    commit();
+                }
+
+                const reg_t inputs = (reg_t)(~lastDdr & lineMask);
+                if(inputs == 0)
+                {
+                    return;
+                }
+
+                gpio_v2_line_values values{};
+                values.mask = inputs;
+                check(chip.ioLayer().ioctl(requestFd, GPIO_V2_LINE_GET_VALUES_IOCTL, &values), "GPIO_V2_LINE_GET_VALUES_IOCTL failed");
+                this->PINx = (reg_t)((this->PINx & (reg_t)~inputs) | ((reg_t)values.bits & inputs));
+            }
+
+            /** @brief @ref commit() followed by @ref refresh(). */
+            void sync()
+            {
+                commit();
+                refresh();
+            }
+
+            /** @brief Bits of the port backed by a chip line. */
+            reg_t lines() const { return lineMask; }
+    };
+
+} // namespace ss
@@ -0,0 +1,257 @@
+/**
+ * @file gpio_chip_fake.hpp
+ * @brief In-memory gpiochip stand-in for tests and benchmarks.
+ *
+ * @details
+ * @ref ss::GPIO_chip_fake_io implements the subset of the gpiochip v2 uAPI used by
+ * @ref ss::GPIO_chip_port without touching the kernel, so the backend can be exercised
+ * on any Linux machine. Line state and per-ioctl call counts can be inspected.
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "gpio_chip.hpp"
+
+namespace ss{
+
+    /**
+     * @class GPIO_chip_fake_io
+     * @brief Simulated gpiochip with a fixed number of lines.
+     */
+    class GPIO_chip_fake_io final : public GPIO_chip_io
+    {
+        /** @brief State of a single simulated line. */
+        struct Line
+        {
+            bool requested = false;  /**< Held by a line request. */
+            bool output = false;     /**< Configured as output. */
+            bool pullUp = false;     /**< Pull-up bias enabled. */
+            bool value = false;      /**< Driven output level. */
+            bool external = false;   /**< Level applied from outside to an input. */
+        };
+
+        static constexpr int chipFd = 100;              /**< Descriptor handed out for the chip. */
+
+        std::string path;                               /**< Accepted device path. */
+        std::vector<Line> lines;                        /**< Simulated lines. */
+        std::map<int, std::vector<std::uint32_t>> requests; /**< Line request fd -> offsets. */
+        std::map<unsigned long, std::size_t> calls;     /**< ioctl request code -> call count. */
+        int nextFd = chipFd + 1;                        /**< Next line request descriptor. */
+
+        static int fail(int error)
+        {
+            errno = error;
+            return -1;
+        }
+
+        void applyConfig(const std::vector<std::uint32_t>& offs, const gpio_v2_line_config& config)
+        {
+            for(std::size_t i = 0; i < offs.size(); ++i)
+            {
+                std::uint64_t flags = config.flags;
+                bool hasValue = false;
+                bool value = false;
+                bool hasFlags = false;
+                for(std::uint32_t a = 0; a < config.num_attrs; ++a)
+                {
+                    const gpio_v2_line_config_attribute& attr = config.attrs[a];
+                    if(((attr.mask >> i) & 1u) == 0)
+                    {
+                        continue;
+                    }
+                    if(attr.attr.id == GPIO_V2_LINE_ATTR_ID_FLAGS && !hasFlags)
+                    {
+                        flags = attr.attr.flags;
+                        hasFlags = true;
+                    }
+                    else if(attr.attr.id == GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES && !hasValue)
+                    {
+                        value = ((attr.attr.values >> i) & 1u) != 0;
+                        hasValue = true;
+                    }
+                }
+
+                Line& line = lines[offs[i]];
+                line.output = (flags & GPIO_V2_LINE_FLAG_OUTPUT) != 0;
+                // Like the kernel, keep the previous bias when no bias flag is given.
+                if((flags & GPIO_V2_LINE_FLAG_BIAS_PULL_UP) != 0)
+                {
+                    line.pullUp = true;
+                }
+                else if((flags & (GPIO_V2_LINE_FLAG_BIAS_DISABLED | GPIO_V2_LINE_FLAG_BIAS_PULL_DOWN)) != 0)
+                {
+                    line.pullUp = false;
+                }
+                line.value = line.output && value;
+            }
+        }
+
+        int getLine(gpio_v2_line_request& request)
+        {
+            if(request.num_lines == 0 || request.num_lines > GPIO_V2_LINES_MAX)
+            {
+                return fail(EINVAL);
+            }
+            std::vector<std::uint32_t> offs(request.offsets, request.offsets + request.num_lines);
+            for(std::uint32_t offset : offs)
+            {
+                if(offset >= lines.size())
+                {
+                    return fail(EINVAL);
+                }
+                if(lines[offset].requested)
+                {
+                    return fail(EBUSY);
+                }
+            }
+            for(std::uint32_t offset : offs)
+            {
+                lines[offset].requested = true;
+            }
+            applyConfig(offs, request.config);
+            request.fd = nextFd++;
+            requests.emplace(request.fd, std::move(offs));
+            return 0;
+        }
+
+        int setValues(const std::vector<std::uint32_t>& offs, const gpio_v2_line_values& values)
+        {
+            for(std::size_t i = 0; i < offs.size(); ++i)
+            {
+                if(((values.mask >> i) & 1u) != 0 && !lines[offs[i]].output)
+                {
+                    return fail(EPERM);
+                }
+            }
+            for(std::size_t i = 0; i < offs.size(); ++i)
+            {
+                if(((values.mask >> i) & 1u) != 0)
+                {
+                    lines[offs[i]].value = ((values.bits >> i) & 1u) != 0;
+                }
+            }
+            return 0;
+        }
+
+        int getValues(const std::vector<std::uint32_t>& offs, gpio_v2_line_values& values) const
+        {
+            std::uint64_t bits = 0;
+            for(std::size_t i = 0; i < offs.size(); ++i)
+            {
+                if(((values.mask >> i) & 1u) != 0 && level(offs[i]))
+                {
+                    bits |= (std::uint64_t)1 << i;
+                }
+            }
+            values.bits = bits;
+            return 0;
+        }
+
+        protected:
+            int doOpen(const char* ppath) override
+            {
+                return path == ppath ? chipFd : fail(ENOENT);
+            }
+
+            int doIoctl(int fd, unsigned long request, void* arg) override
+            {
+                ++calls[request];
+
+                if(fd == chipFd)
+                {
+                    if(request == GPIO_V2_GET_LINE_IOCTL)
+                    {
+                        return getLine(*static_cast<gpio_v2_line_request*>(arg));
+                    }
+                    return fail(ENOTTY);
+                }
+
+                auto it = requests.find(fd);
+                if(it == requests.end())
+                {
+                    return fail(EBADF);
+                }
+                switch(request)
+                {
+                    case GPIO_V2_LINE_SET_CONFIG_IOCTL:
+                        applyConfig(it->second, *static_cast<gpio_v2_line_config*>(arg));
+                        return 0;
+                    case GPIO_V2_LINE_SET_VALUES_IOCTL:
+                        return setValues(it->second, *static_cast<gpio_v2_line_values*>(arg));
+                    case GPIO_V2_LINE_GET_VALUES_IOCTL:
+                        return getValues(it->second, *static_cast<gpio_v2_line_values*>(arg));
+                    default:
+                        return fail(ENOTTY);
+                }
+            }
+
+            int doClose(int fd) override
+            {
+                if(fd == chipFd)
+                {
+                    return 0;
+                }
+                auto it = requests.find(fd);
+                if(it == requests.end())
+                {
+                    return fail(EBADF);
+                }
+                for(std::uint32_t offset : it->second)
+                {
+                    lines[offset] = Line{};
+                }
+                requests.erase(it);
+                return 0;
+            }
+
+        public:
+            /**
+             * @brief Create a fake chip.
+             *
+             * @param ppath     Device path accepted by open().
+             * @param numLines  Number of lines on the chip.
+             */
+            GPIO_chip_fake_io(std::string ppath, std::size_t numLines) : path(std::move(ppath)), lines(numLines)
+            {
+            }
+
+            /** @brief Level seen on a line: driven value for outputs, external or pull-up level for inputs. */
+            bool level(std::uint32_t offset) const
+            {
+                const Line& line = lines.at(offset);
+                return line.output ? line.value : (line.external || line.pullUp);
+            }
+
+            /** @brief Drive an input line from outside the chip. */
+            void setExternal(std::uint32_t offset, bool high)
+            {
+                lines.at(offset).external = high;
+            }
+
+            /** @brief Whether the line is configured as output. */
+            bool isOutput(std::uint32_t offset) const { return lines.at(offset).output; }
+
+            /** @brief Whether the line has the pull-up bias enabled. */
+            bool isPullUp(std::uint32_t offset) const { return lines.at(offset).pullUp; }
+
+            /** @brief Whether the line is held by a line request. */
+            bool isRequested(std::uint32_t offset) const { return lines.at(offset).requested; }
+
+            /** @brief Number of ioctl() calls issued with the given request code. */
+            std::size_t callCount(unsigned long request) const
+            {
+                auto it = calls.find(request);
+                return it == calls.end() ? 0 : it->second;
+            }
+
+            /** @brief Number of line requests currently open. */
+            std::size_t openRequests() const { return requests.size(); }
+    };
+
+} // namespace ss
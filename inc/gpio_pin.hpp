@@ -72,7 +72,7 @@ namespace ss{
                     port.setBit(bit, false);
                     break;
                 default:
-                    throw std::invalid_argument("wanted invalid state of a pin"); 
+                    detail::throwInvalidArgument("wanted invalid state of a pin");
             }
         }
 
@@ -91,7 +91,7 @@ namespace ss{
                     port.pullUpBit(bit, true);
                     break;
                 default:
-                    throw std::invalid_argument("wanted invalid mode of a pin"); 
+                    detail::throwInvalidArgument("wanted invalid mode of a pin");
             }
         }
 
@@ -107,7 +107,7 @@ namespace ss{
                     port.pullUpBit(bit, true);
                     break;
                 default:
-                    throw std::invalid_argument("wanted invalid pull mode of a pin"); 
+                    detail::throwInvalidArgument("wanted invalid pull mode of a pin");
             }
         }
         
@@ -3,15 +3,54 @@
  * @brief GPIO port backend operating on registers.
  */
 #pragma once
+#include <cstddef>
 #include <cstdint>
 #include <type_traits>
 #include <stdexcept>
 #include <bitset>
+#include <iostream>
+#include <limits>
 
 #include "mcu_type.hpp"
 
 namespace ss{
 
+    namespace detail{
+
+        /**
+         * @brief Throw @c std::out_of_range.
+         *
+         * @details
+         * Kept cold and out of line so inlined hot paths only carry a branch and a call.
+         */
+        [[noreturn, gnu::cold, gnu::noinline]] inline void throwOutOfRange(const char* what)
+        {
+            throw std::out_of_range(what);
+        }
+
+        /** @brief Throw @c std::invalid_argument, see @ref throwOutOfRange. */
+        [[noreturn, gnu::cold, gnu::noinline]] inline void throwInvalidArgument(const char* what)
+        {
+            throw std::invalid_argument(what);
+        }
+
+        /**
+         * @brief In-memory DDR/PORT/PIN storage for ports without hardware registers.
+         *
+         * @details
+         * Used as the first base of such ports so the registers exist before
+         * @ref GPIO_port binds its references to them.
+         */
+        template <typename reg_t>
+        struct GPIO_registers
+        {
+            volatile reg_t ddr = 0;   /**< Data Direction register. */
+            volatile reg_t port = 0;  /**< Output / pull-up control register. */
+            volatile reg_t pin = 0;   /**< Input register. */
+        };
+
+    } // namespace detail
+
     /**
      * @brief GPIO port for DDR/PORT/PIN registers.
      *
@@ -29,10 +68,88 @@ namespace ss{
 
             static constexpr reg_t bitMask(reg_t bit)
             {
-                return (reg_t)(1 << bit);
+                return (reg_t)((reg_t)1 << bit);
             }
 
         public:
+            /**
+             * @brief Saved DDR/PORT/PIN register values of a port.
+             *
+             * @details
+             * Returned by @ref snapshot(). When returned by @ref diff() the fields
+             * hold masks of the bits that differ instead of register values.
+             */
+            struct Snapshot
+            {
+                reg_t ddr = 0;   /**< Data Direction register. */
+                reg_t port = 0;  /**< Output / pull-up control register. */
+                reg_t pin = 0;   /**< Input register. */
+
+                /** @brief true if any bit is set in any register. */
+                constexpr bool any() const { return (ddr | port | pin) != 0; }
+
+                constexpr bool operator==(const Snapshot&) const = default;
+            };
+
+            /** @brief Register selector used by @ref RestorePlan. */
+            enum class Register
+            {
+                ddr,   /**< Data Direction register. */
+                port,  /**< Output / pull-up control register. */
+                pin    /**< Input register. */
+            };
+
+            /** @brief Single register write of a @ref RestorePlan. */
+            struct RegisterWrite
+            {
+                Register reg;   /**< Written register. */
+                reg_t value;    /**< New register value. */
+            };
+
+            /** @brief Ordered register writes performed by @ref restore(). */
+            struct RestorePlan
+            {
+                RegisterWrite writes[4] = {};   /**< Writes in execution order. */
+                std::size_t count = 0;          /**< Number of valid writes. */
+            };
+
+            /**
+             * @brief Compute the writes that turn one register state into another.
+             * @param current State the registers are in.
+             * @param saved   State to restore.
+             * @return Writes in the order @ref restore() performs them.
+             *
+             * @details
+             * Only registers that differ are written. To avoid glitches, pins that
+             * become inputs are released (DDR) before PORT changes, and pins that
+             * become outputs are driven (DDR) only after PORT holds their new level.
+             */
+            static constexpr RestorePlan planRestore(const Snapshot& current, const Snapshot& saved)
+            {
+                RestorePlan plan;
+                const reg_t changedDdr = (reg_t)(current.ddr ^ saved.ddr);
+                const reg_t toInput = (reg_t)(changedDdr & current.ddr);
+                const reg_t toOutput = (reg_t)(changedDdr & saved.ddr);
+
+                if(toInput != 0)
+                {
+                    plan.writes[plan.count++] = RegisterWrite{Register::ddr, (reg_t)(current.ddr & (reg_t)~toInput)};
+                }
+                if(current.port != saved.port)
+                {
+                    plan.writes[plan.count++] = RegisterWrite{Register::port, saved.port};
+                }
+                if(toOutput != 0)
+                {
+                    plan.writes[plan.count++] = RegisterWrite{Register::ddr, saved.ddr};
+                }
+                if(current.pin != saved.pin)
+                {
+                    plan.writes[plan.count++] = RegisterWrite{Register::pin, saved.pin};
+                }
+                return plan;
+            }
+
             /**
              * @brief Construct a port registers.
              *
@@ -42,46 +159,26 @@ namespace ss{
              */
             GPIO_port(volatile reg_t& ddr, volatile reg_t& port, volatile reg_t& pin) : DDRx(ddr), PORTx(port), PINx(pin) 
             {
-                static_assert(sizeof(reg_t) == 1 || sizeof(reg_t) == 4, "Unsupported register type: must be 8-bit or 32-bit");
+                static_assert(std::numeric_limits<reg_t>::is_integer && !std::numeric_limits<reg_t>::is_signed, "Unsupported register type: must be an unsigned integer");
             };
 
 
+            /** @brief Number of bits in a register. */
+            static constexpr reg_t width = (reg_t)std::numeric_limits<reg_t>::digits;
+
             /**
              * @brief Validate bit index for the underlying register width.
              * @param bit Bit index.
              * @return true if valid.
              * @throws std::out_of_range If bit is out of range.
-             * @throws std::runtime_error If register type is unsupported.
              */
             bool validateBit(reg_t bit) const 
             {
-                if constexpr(std::is_same_v<reg_t, uint8_t>)
-                {
-                    if(bit > 7) 
-                    {
-                        throw std::out_of_range("Pin out of range!");
-                    }
-                    else
-                    {
-                        return true;
-                    } 
-                }
-                else if constexpr (std::is_same_v<reg_t, uint32_t>)
+                if(bit > width - 1) 
                 {
-                    if(bit > 31) 
-                    {
-                        throw std::out_of_range("Pin out of range!");
-                    }
-                    else
-                    {
-                        return true;
-                    } 
-                }
-                else 
-                {
-                    throw std::runtime_error("Wrong type of registers");
-                    return false;
+                    detail::throwOutOfRange("Pin out of range!");
                 }
+                return true;
             }
 
         /**
@@ -114,6 +211,29 @@ namespace ss{
         }
 
 
+        /**
+         * @brief Set direction of several bits at once.
+         * @param mask      Bits to modify.
+         * @param is_output true for output, false for input.
+         *
+         * @details Port-wide counterpart of @ref setDirection.
+         */
+        void setDirectionBits(reg_t mask, bool is_output)
+        {
+            if(is_output)
+            {
+                DDRx = (reg_t)(DDRx | mask);
+                PORTx = (reg_t)(PORTx & (reg_t)~mask);
+                PINx = (reg_t)(PINx & (reg_t)~mask);
+            }
+            else
+            {
+                DDRx = (reg_t)(DDRx & (reg_t)~mask);
+                PORTx = (reg_t)(PORTx | mask);
+                PINx = (reg_t)(PINx | mask);
+            }
+        }
+
         /**
          * @brief Set output state of a bit.
          * @param bit Bit index.
@@ -160,6 +280,77 @@ namespace ss{
         }
 
 
+        /**
+         * @brief Set output state of several bits at once.
+         * @param mask   Bits to modify.
+         * @param values New levels for the bits selected by @p mask.
+         *
+         * @details
+         * Port-wide counterpart of @ref setBit: every selected bit is updated
+         * with a single read-modify-write of each register.
+         */
+        void setBits(reg_t mask, reg_t values)
+        {
+            PORTx = (reg_t)((PORTx & (reg_t)~mask) | (values & mask));
+            PINx = (reg_t)((PINx & (reg_t)~mask) | (values & mask));
+        }
+
+        /**
+         * @brief Read input state of several bits at once.
+         * @param mask Bits to read.
+         * @return Input register masked with @p mask.
+         */
+        reg_t readBits(reg_t mask) const
+        {
+            return (reg_t)(PINx & mask);
+        }
+
+        /**
+         * @brief Save current register values.
+         * @return Copy of DDR, PORT and PIN.
+         */
+        Snapshot snapshot() const
+        {
+            return Snapshot{DDRx, PORTx, PINx};
+        }
+
+        /**
+         * @brief Compare current register values with a snapshot.
+         * @param saved Snapshot to compare against.
+         * @return Masks of bits that differ in each register (XOR).
+         */
+        Snapshot diff(const Snapshot& saved) const
+        {
+            return Snapshot{(reg_t)(DDRx ^ saved.ddr), (reg_t)(PORTx ^ saved.port), (reg_t)(PINx ^ saved.pin)};
+        }
+
+        /**
+         * @brief Restore register values from a snapshot.
+         * @param saved Snapshot to restore.
+         *
+         * @details Performs the writes of @ref planRestore() in order.
+         */
+        void restore(const Snapshot& saved)
+        {
+            const RestorePlan plan = planRestore(snapshot(), saved);
+            for(std::size_t i = 0; i < plan.count; ++i)
+            {
+                const RegisterWrite& write = plan.writes[i];
+                switch(write.reg)
+                {
+                    case Register::ddr:
+                        DDRx = write.value;
+                        break;
+                    case Register::port:
+                        PORTx = write.value;
+                        break;
+                    case Register::pin:
+                        PINx = write.value;
+                        break;
+                }
+            }
+        }
+
         /**
          * @brief Enable/disable pull-up for a bit.
          * @param bit Bit index.
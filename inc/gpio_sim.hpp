@@ -0,0 +1,408 @@
+/**
+ * @file gpio_sim.hpp
+ * @brief Multi-threaded board simulator for large numbers of GPIO ports.
+ *
+ * @details
+ * @ref ss::GPIO_sim owns simulated ports (@ref ss::GPIO_sim_port), tasks attached to
+ * them and wires connecting output pins to input pins, possibly on other ports.
+ *
+ * Every tick runs in two phases separated by a barrier:
+ *  - each port runs its tasks and applies its pending writes in one batch,
+ *  - each port samples the outputs driving its wired inputs.
+ *
+ * A port is only written by the thread processing it in the current phase, so tasks
+ * need no locking as long as they only touch their own port. Inputs driven by wires
+ * see the outputs of the previous tick; results do not depend on the thread count.
+ *
+ * Ports are split into fixed-size chunks, and chunks into one shard per worker. A worker
+ * drains its own shard first and then steals remaining chunks from the other shards.
+ */
+#pragma once
+#include <atomic>
+#include <barrier>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <latch>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "mcu_type.hpp"
+#include "gpio_port.hpp"
+
+namespace ss{
+
+    template<McuType T>
+    class GPIO_sim;
+
+    /**
+     * @brief GPIO port living in a @ref GPIO_sim.
+     *
+     * @tparam T MCU register type constrained by @ref ss::McuType.
+     *
+     * @details
+     * Behaves like any @ref GPIO_port, so @ref GPIO_pin can be bound to it. Writes
+     * queued with @ref queueBits() are merged and applied once at the end of the
+     * port's task phase.
+     */
+    template<McuType T>
+    class alignas(64) GPIO_sim_port : private detail::GPIO_registers<std::remove_cv_t<T>>, public GPIO_port<std::remove_cv_t<T>>
+    {
+        using reg_t = std::remove_cv_t<T>;           /**< Register type without cv-qualifiers. */
+        using registers_t = detail::GPIO_registers<reg_t>;
+
+        friend class GPIO_sim<T>;
+
+        reg_t pendingSet = 0;     /**< Bits queued to go high. */
+        reg_t pendingClear = 0;   /**< Bits queued to go low. */
+        reg_t driven = 0;         /**< Output levels published for wired inputs. */
+        std::vector<std::function<void(GPIO_sim_port&)>> tasks;  /**< Tasks run every tick. */
+
+        /** @brief Run tasks, apply pending writes and publish outputs. */
+        void step()
+        {
+            for(auto& task : tasks)
+            {
+                task(*this);
+            }
+            if((pendingSet | pendingClear) != 0)
+            {
+                this->setBits((reg_t)(pendingSet | pendingClear), pendingSet);
+                pendingSet = 0;
+                pendingClear = 0;
+            }
+            driven = (reg_t)(this->PORTx & this->DDRx);
+        }
+
+        public:
+            GPIO_sim_port() : GPIO_port<reg_t>(registers_t::ddr, registers_t::port, registers_t::pin)
+            {
+            }
+
+            GPIO_sim_port(const GPIO_sim_port&) = delete;
+            GPIO_sim_port& operator=(const GPIO_sim_port&) = delete;
+
+            /**
+             * @brief Queue an output write applied at the end of the task phase.
+             * @param mask   Bits to modify.
+             * @param values New levels for the bits selected by @p mask.
+             *
+             * @details Later writes to the same bit within a tick override earlier ones.
+             */
+            void queueBits(reg_t mask, reg_t values)
+            {
+                const reg_t high = (reg_t)(mask & values);
+                const reg_t low = (reg_t)(mask & ~values);
+                pendingSet = (reg_t)((pendingSet & ~low) | high);
+                pendingClear = (reg_t)((pendingClear & ~high) | low);
+            }
+    };
+
+    /**
+     * @brief Sharded multi-threaded simulator of many @ref GPIO_sim_port instances.
+     *
+     * @tparam T MCU register type constrained by @ref ss::McuType.
+     */
+    template<McuType T>
+    class GPIO_sim
+    {
+        using reg_t = std::remove_cv_t<T>;   /**< Register type without cv-qualifiers. */
+
+        public:
+            using Port = GPIO_sim_port<T>;                      /**< Simulated port type. */
+            using Task = std::function<void(Port&)>;            /**< Task run on its port every tick. */
+
+            static constexpr std::size_t chunkSize = 32;        /**< Ports processed per claimed chunk. */
+
+        private:
+            /**
+             * @brief Wires from one source port into one destination port with the same bit shift.
+             *
+             * @details Driven bits are @c (src.driven & mask) shifted left by @c shift (right if negative).
+             */
+            struct Link
+            {
+                const Port* src;   /**< Driving port. */
+                reg_t mask;        /**< Source bits. */
+                int shift;         /**< Destination bit minus source bit. */
+            };
+
+            /** @brief Wire as declared by @ref connect(). */
+            struct Wire
+            {
+                std::size_t srcPort;
+                reg_t srcBit;
+                std::size_t dstPort;
+                reg_t dstBit;
+            };
+
+            /** @brief Range of chunks owned by a worker, claimed by owner and thieves alike. */
+            struct alignas(64) Shard
+            {
+                std::atomic<std::size_t> next{0};   /**< Next unclaimed chunk. */
+                std::size_t end = 0;                /**< One past the last chunk. */
+            };
+
+            std::deque<Port> ports;                         /**< Ports, stable addresses. */
+            std::vector<Wire> wires;                        /**< Declared wires. */
+            std::vector<std::vector<Link>> links;           /**< Per destination port links. */
+            std::vector<reg_t> wiredInputs;                 /**< Per destination port driven bits. */
+            bool graphDirty = true;                         /**< Wires changed since last build. */
+
+            std::size_t threads;                            /**< Worker count. */
+            std::vector<Shard> shards;                      /**< One shard per worker. */
+            std::uint64_t ticks = 0;                        /**< Completed ticks. */
+
+            std::mutex errorLock;                           /**< Guards @ref error. */
+            std::exception_ptr error;                       /**< First exception thrown by a task. */
+
+            /** @brief Group wires by destination port and (source port, shift). */
+            void buildGraph()
+            {
+                links.assign(ports.size(), {});
+                wiredInputs.assign(ports.size(), 0);
+                for(const Wire& wire : wires)
+                {
+                    const Port* src = &ports[wire.srcPort];
+                    const int shift = (int)wire.dstBit - (int)wire.srcBit;
+                    std::vector<Link>& dst = links[wire.dstPort];
+
+                    bool merged = false;
+                    for(Link& link : dst)
+                    {
+                        if(link.src == src && link.shift == shift)
+                        {
+                            link.mask |= (reg_t)((reg_t)1 << wire.srcBit);
+                            merged = true;
+                            break;
+                        }
+                    }
+                    if(!merged)
+                    {
+                        dst.push_back(Link{src, (reg_t)((reg_t)1 << wire.srcBit), shift});
+                    }
+                    wiredInputs[wire.dstPort] |= (reg_t)((reg_t)1 << wire.dstBit);
+                }
+                graphDirty = false;
+            }
+
+            /** @brief Drive wired input bits of a port from the published outputs. */
+            void propagate(std::size_t index)
+            {
+                const reg_t wired = wiredInputs[index];
+                if(wired == 0)
+                {
+                    return;
+                }
+
+                reg_t level = 0;
+                for(const Link& link : links[index])
+                {
+                    const reg_t bits = (reg_t)(link.src->driven & link.mask);
+                    level |= link.shift >= 0 ? (reg_t)(bits << link.shift) : (reg_t)(bits >> -link.shift);
+                }
+
+                Port& port = ports[index];
+                const reg_t inputs = (reg_t)(wired & ~port.DDRx);
+                port.PINx = (reg_t)((port.PINx & (reg_t)~inputs) | (level & inputs));
+            }
+
+            void step(std::size_t index)
+            {
+                try
+                {
+                    ports[index].step();
+                }
+                catch(...)
+                {
+                    std::lock_guard<std::mutex> guard(errorLock);
+                    if(!error)
+                    {
+                        error = std::current_exception();
+                    }
+                }
+            }
+
+            /** @brief Split chunks evenly between shards. */
+            void resetShards()
+            {
+                const std::size_t chunks = (ports.size() + chunkSize - 1) / chunkSize;
+                for(std::size_t i = 0; i < shards.size(); ++i)
+                {
+                    shards[i].next.store(chunks * i / shards.size(), std::memory_order_relaxed);
+                    shards[i].end = chunks * (i + 1) / shards.size();
+                }
+            }
+
+            /**
+             * @brief Process chunks of the own shard, then steal from the others.
+             * @param worker Index of the calling worker.
+             * @param work   Per-port operation.
+             */
+            template <typename Work>
+            void drain(std::size_t worker, Work work)
+            {
+                for(std::size_t k = 0; k < shards.size(); ++k)
+                {
+                    Shard& shard = shards[(worker + k) % shards.size()];
+                    for(;;)
+                    {
+                        const std::size_t chunk = shard.next.fetch_add(1, std::memory_order_relaxed);
+                        if(chunk >= shard.end)
+                        {
+                            break;
+                        }
+                        const std::size_t first = chunk * chunkSize;
+                        const std::size_t last = first + chunkSize < ports.size() ? first + chunkSize : ports.size();
+                        for(std::size_t i = first; i < last; ++i)
+                        {
+                            work(i);
+                        }
+                    }
+                }
+            }
+
+        public:
+            /**
+             * @brief Construct an empty simulator.
+             * @param pthreads Number of worker threads, 0 for hardware concurrency.
+             */
+            explicit GPIO_sim(std::size_t pthreads = 0)
+                : threads(pthreads != 0 ? pthreads : (std::thread::hardware_concurrency() != 0 ? std::thread::hardware_concurrency() : 1)),
+                  shards(threads)
+            {
+            }
+
+            GPIO_sim(const GPIO_sim&) = delete;
+            GPIO_sim& operator=(const GPIO_sim&) = delete;
+
+            /**
+             * @brief Add a port.
+             * @return Index of the new port.
+             */
+            std::size_t addPort()
+            {
+                ports.emplace_back();
+                graphDirty = true;
+                return ports.size() - 1;
+            }
+
+            /** @brief Access a port by index. */
+            Port& port(std::size_t index) { return ports.at(index); }
+
+            /** @brief Number of ports. */
+            std::size_t size() const { return ports.size(); }
+
+            /** @brief Number of worker threads. */
+            std::size_t workers() const { return threads; }
+
+            /** @brief Number of completed ticks. */
+            std::uint64_t tick() const { return ticks; }
+
+            /**
+             * @brief Attach a task run on its port every tick.
+             * @param index Port index.
+             * @param task  Callable receiving the port; must only touch that port.
+             */
+            void addTask(std::size_t index, Task task)
+            {
+                ports.at(index).tasks.push_back(std::move(task));
+            }
+
+            /**
+             * @brief Wire an output pin to an input pin.
+             *
+             * @param srcPort Driving port index.
+             * @param srcBit  Driving bit.
+             * @param dstPort Driven port index, may equal @p srcPort.
+             * @param dstBit  Driven bit, follows the source while configured as input.
+             *
+             * @throws std::out_of_range If a port or bit index is invalid.
+             */
+            void connect(std::size_t srcPort, reg_t srcBit, std::size_t dstPort, reg_t dstBit)
+            {
+                ports.at(srcPort).validateBit(srcBit);
+                ports.at(dstPort).validateBit(dstBit);
+                wires.push_back(Wire{srcPort, srcBit, dstPort, dstBit});
+                graphDirty = true;
+            }
+
+            /**
+             * @brief Simulate a number of ticks.
+             * @param count Number of ticks.
+             * @throws Rethrows the first exception thrown by a task, after the run finished.
+             * @throws std::system_error If a worker thread cannot be started; no tick is simulated then.
+             */
+            void run(std::uint64_t count)
+            {
+                if(count == 0 || ports.empty())
+                {
+                    ticks += count;
+                    return;
+                }
+                if(graphDirty)
+                {
+                    buildGraph();
+                }
+
+                resetShards();
+                auto onPhaseEnd = [this]() noexcept { resetShards(); };
+                std::barrier sync((std::ptrdiff_t)threads, onPhaseEnd);
+
+                // Workers only reach the barrier once the whole pool exists; if starting
+                // a thread fails, the already started ones leave without blocking.
+                std::latch started(1);
+                bool aborted = false;
+
+                auto worker = [&](std::size_t id)
+                {
+                    started.wait();
+                    if(aborted)
+                    {
+                        return;
+                    }
+                    for(std::uint64_t t = 0; t < count; ++t)
+                    {
+                        drain(id, [this](std::size_t i) { step(i); });
+                        sync.arrive_and_wait();
+                        drain(id, [this](std::size_t i) { propagate(i); });
+                        sync.arrive_and_wait();
+                    }
+                };
+
+                {
+                    std::vector<std::jthread> pool;
+                    try
+                    {
+                        pool.reserve(threads - 1);
+                        for(std::size_t id = 1; id < threads; ++id)
+                        {
+                            pool.emplace_back(worker, id);
+                        }
+                    }
+                    catch(...)
+                    {
+                        aborted = true;
+                        started.count_down();
+                        throw;
+                    }
+                    started.count_down();
+                    worker(0);
+                }
+                ticks += count;
+
+                if(error)
+                {
+                    std::exception_ptr thrown = error;
+                    error = nullptr;
+                    std::rethrow_exception(thrown);
+                }
+            }
+    };
+
+} // namespace ss
@@ -0,0 +1,225 @@
+/**
+ * @file gpio_wide_port.hpp
+ * @brief Logical wide GPIO port built from several @ref ss::GPIO_port instances.
+ *
+ * @details
+ * @ref ss::GPIO_wide_port joins @c N ports of the same register type into one port of
+ * @c N * width bits, e.g. two 64-bit ports into a 128-bit port. Bit @c i lives in port
+ * @c i / width at bit @c i % width.
+ *
+ * Masks are arrays with one word per backing port, so splitting a mask is free. Mask
+ * operations touch every backing register at most once; the overloads taking the mask
+ * as a template argument skip ports with an empty mask word at compile time.
+ */
+#pragma once
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "mcu_type.hpp"
+#include "gpio_port.hpp"
+
+namespace ss{
+
+    /**
+     * @brief Wide GPIO port over @p N backing ports.
+     *
+     * @tparam T MCU register type constrained by @ref ss::McuType.
+     * @tparam N Number of backing ports.
+     */
+    template<McuType T, std::size_t N>
+    class GPIO_wide_port
+    {
+        static_assert(N > 0, "GPIO_wide_port needs at least one port");
+
+        using reg_t = std::remove_cv_t<T>;       /**< Register type without cv-qualifiers. */
+        using port_t = GPIO_port<reg_t>;         /**< Backing port type. */
+
+        public:
+            using mask_t = std::array<reg_t, N>; /**< One mask word per backing port, lowest bits first. */
+
+            static constexpr std::size_t portWidth = port_t::width;   /**< Bits per backing port. */
+            static constexpr std::size_t width = portWidth * N;       /**< Bits of the wide port. */
+
+        private:
+            std::array<port_t*, N> ports;        /**< Backing ports, lowest bits first. */
+
+            template<std::size_t... I>
+            void setBitsSplit(const mask_t& mask, const mask_t& values, std::index_sequence<I...>)
+            {
+                (ports[I]->setBits(mask[I], values[I]), ...);
+            }
+
+            template<mask_t Mask, std::size_t... I>
+            void setBitsSplit(const mask_t& values, std::index_sequence<I...>)
+            {
+                ([&]
+                {
+                    if constexpr(Mask[I] != 0)
+                    {
+                        ports[I]->setBits(Mask[I], values[I]);
+                    }
+                }(), ...);
+            }
+
+            template<std::size_t... I>
+            mask_t readBitsSplit(const mask_t& mask, std::index_sequence<I...>) const
+            {
+                return mask_t{ports[I]->readBits(mask[I])...};
+            }
+
+            template<mask_t Mask, std::size_t... I>
+            mask_t readBitsSplit(std::index_sequence<I...>) const
+            {
+                mask_t result{};
+                ([&]
+                {
+                    if constexpr(Mask[I] != 0)
+                    {
+                        result[I] = ports[I]->readBits(Mask[I]);
+                    }
+                }(), ...);
+                return result;
+            }
+
+            static void validateBit(std::size_t bit)
+            {
+                if(bit >= width)
+                {
+                    detail::throwOutOfRange("Pin out of range!");
+                }
+            }
+
+        public:
+            /**
+             * @brief Construct a wide port from its backing ports.
+             *
+             * @param first First port, holds the lowest bits.
+             * @param rest  Remaining ports in ascending bit order.
+             *
+             * @details Any port derived from @ref GPIO_port may be used, e.g. @ref GPIO_sim_port.
+             */
+            template<typename... Ports>
+                requires (sizeof...(Ports) + 1 == N && (std::derived_from<Ports, port_t> && ...))
+            GPIO_wide_port(port_t& first, Ports&... rest) : ports{&first, &rest...}
+            {
+            }
+
+            /**
+             * @brief Mask with a single bit set.
+             * @param bit Bit index in the wide port.
+             */
+            static constexpr mask_t bitMask(std::size_t bit)
+            {
+                mask_t mask{};
+                mask[bit / portWidth] = (reg_t)((reg_t)1 << (bit % portWidth));
+                return mask;
+            }
+
+            /**
+             * @brief Set pin direction.
+             * @param bit Bit index in the wide port.
+             * @param is_output true for output, false for input.
+             * @throws std::out_of_range If bit is out of range.
+             */
+            void setDirection(std::size_t bit, bool is_output)
+            {
+                validateBit(bit);
+                ports[bit / portWidth]->setDirection((reg_t)(bit % portWidth), is_output);
+            }
+
+            /**
+             * @brief Set output state of a bit.
+             * @param bit Bit index in the wide port.
+             * @param to_high true for high, false for low.
+             * @throws std::out_of_range If bit is out of range.
+             */
+            void setBit(std::size_t bit, bool to_high)
+            {
+                validateBit(bit);
+                ports[bit / portWidth]->setBit((reg_t)(bit % portWidth), to_high);
+            }
+
+            /**
+             * @brief Read input state of a bit.
+             * @param bit Bit index in the wide port.
+             * @return true if high, false if low.
+             * @throws std::out_of_range If bit is out of range.
+             */
+            bool readBit(std::size_t bit) const
+            {
+                validateBit(bit);
+                return ports[bit / portWidth]->readBit((reg_t)(bit % portWidth));
+            }
+
+            /**
+             * @brief Set direction of the masked bits, each backing port once.
+             * @param mask      Bits to modify.
+             * @param is_output true for output, false for input.
+             */
+            void setDirectionBits(const mask_t& mask, bool is_output)
+            {
+                for(std::size_t i = 0; i < N; ++i)
+                {
+                    if(mask[i] != 0)
+                    {
+                        ports[i]->setDirectionBits(mask[i], is_output);
+                    }
+                }
+            }
+
+            /**
+             * @brief Set output state of the masked bits.
+             * @param mask   Bits to modify.
+             * @param values New levels for the bits selected by @p mask.
+             *
+             * @details Every backing register is written exactly once.
+             */
+            void setBits(const mask_t& mask, const mask_t& values)
+            {
+                setBitsSplit(mask, values, std::make_index_sequence<N>{});
+            }
+
+            /**
+             * @brief Set output state of the bits of a compile-time mask.
+             * @tparam Mask Bits to modify; ports with an empty mask word are not touched.
+             * @param values New levels for the bits selected by @p Mask.
+             */
+            template<mask_t Mask>
+            void setBits(const mask_t& values)
+            {
+                setBitsSplit<Mask>(values, std::make_index_sequence<N>{});
+            }
+
+            /**
+             * @brief Read input state of the masked bits.
+             * @param mask Bits to read.
+             * @return Input registers masked with @p mask.
+             */
+            mask_t readBits(const mask_t& mask) const
+            {
+                return readBitsSplit(mask, std::make_index_sequence<N>{});
+            }
+
+            /**
+             * @brief Read input state of the bits of a compile-time mask.
+             * @tparam Mask Bits to read; ports with an empty mask word are not touched.
+             * @return Input registers masked with @p Mask.
+             */
+            template<mask_t Mask>
+            mask_t readBits() const
+            {
+                return readBitsSplit<Mask>(std::make_index_sequence<N>{});
+            }
+
+            /** @brief Backing port holding mask word @p index. */
+            port_t& port(std::size_t index) const { return *ports.at(index); }
+    };
+
+    /** @brief Deduce register type and port count from the constructor arguments. */
+    template<McuType T, typename... Ports>
+    GPIO_wide_port(GPIO_port<T>&, Ports&...) -> GPIO_wide_port<T, sizeof...(Ports) + 1>;
+
+} // namespace ss
@@ -19,14 +19,16 @@ namespace ss {
  * @brief Compile-time constraint for supported MCU register-width types.
  *
  * @details
- * Accepts @c uint8_t and @c uint32_t (after removing @c const / @c volatile qualifiers),
+ * Accepts @c uint8_t, @c uint16_t, @c uint32_t and @c uint64_t (after removing @c const / @c volatile qualifiers),
  *
  * @tparam T Candidate type to validate.
  */
 template <typename T>
 concept McuType =
     std::same_as<std::remove_cv_t<T>, uint8_t> ||
-    std::same_as<std::remove_cv_t<T>, uint32_t>;
+    std::same_as<std::remove_cv_t<T>, uint16_t> ||
+    std::same_as<std::remove_cv_t<T>, uint32_t> ||
+    std::same_as<std::remove_cv_t<T>, uint64_t>;
 
 
 /** @brief alias representing 32-bit MCU register width (typical for ARM). */
@@ -0,0 +1,137 @@
+# Checks generated code of hot-path functions against checked-in budgets.
+#
+# Usage:
+#   cmake -DOBJDUMP=<objdump> -DOBJECTS=<object files> -DBUDGETS=<budget file> -P check_codegen.cmake
+#
+# For every function listed in the budget file the hot part of its disassembly
+# (without the compiler-split .cold part) must:
+#   - have at most max_instructions instructions (nop padding excluded),
+#   - be at most max_bytes long,
+#   - contain no call and no tail jump to another function.
+# Neither the hot nor the .cold part may reference the C++ exception runtime
+# (__cxa_*): throws belong in out-of-line helpers such as ss::detail::throwOutOfRange.
+
+cmake_minimum_required(VERSION 3.20)
+
+foreach(var OBJDUMP OBJECTS BUDGETS)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "check_codegen.cmake: ${var} is not set")
+    endif()
+endforeach()
+
+set(functions "")
+file(STRINGS "${BUDGETS}" budget_lines)
+foreach(line IN LISTS budget_lines)
+    if(line MATCHES "^[ \t]*(#|$)")
+        continue()
+    endif()
+    if(NOT line MATCHES "^[ \t]*([A-Za-z0-9_]+)[ \t]+([0-9]+)[ \t]+([0-9]+)[ \t]*$")
+        message(FATAL_ERROR "Malformed budget line: ${line}")
+    endif()
+    list(APPEND functions ${CMAKE_MATCH_1})
+    set(max_insns_${CMAKE_MATCH_1} ${CMAKE_MATCH_2})
+    set(max_bytes_${CMAKE_MATCH_1} ${CMAKE_MATCH_3})
+endforeach()
+
+set(dump "")
+foreach(object IN LISTS OBJECTS)
+    execute_process(
+        COMMAND "${OBJDUMP}" -d -r "${object}"
+        OUTPUT_VARIABLE object_dump
+        RESULT_VARIABLE result
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "${OBJDUMP} failed on ${object}")
+    endif()
+    string(APPEND dump "${object_dump}\n")
+endforeach()
+
+# Keep list splitting intact: no ';' and no brackets inside list items.
+string(REPLACE ";" "," dump "${dump}")
+string(REPLACE "[" "(" dump "${dump}")
+string(REPLACE "]" ")" dump "${dump}")
+string(REPLACE "\n" ";" dump_lines "${dump}")
+
+# A <fn>.cold part may be listed before or after <fn>, so its findings are kept
+# in cold_errors_<fn>, which the header of <fn> does not reset.
+set(current "")
+set(cold "")
+set(last_mnemonic "")
+foreach(line IN LISTS dump_lines)
+    if(line MATCHES "^[0-9a-f]+ <([^>]+)\\.cold>:$")
+        set(current "")
+        set(cold "${CMAKE_MATCH_1}")
+    elseif(line MATCHES "^[0-9a-f]+ <([^>]+)>:$")
+        set(current "${CMAKE_MATCH_1}")
+        set(cold "")
+        set(insns_${current} 0)
+        set(bytes_${current} 0)
+        set(errors_${current} "")
+        set(seen_${current} TRUE)
+        set(last_mnemonic "")
+    elseif(NOT cold STREQUAL "")
+        if(line MATCHES "^\t+[0-9a-f]+: R_[A-Z0-9_]+\t([^ \t+-]+)")
+            set(symbol "${CMAKE_MATCH_1}")
+            if(symbol MATCHES "__cxa_")
+                list(APPEND cold_errors_${cold} "reference to ${symbol} in ${cold}.cold")
+            endif()
+        endif()
+    elseif(current STREQUAL "")
+        continue()
+    elseif(line MATCHES "^ +[0-9a-f]+:\t([0-9a-f ]+)\t([a-z0-9.]+)")
+        set(raw "${CMAKE_MATCH_1}")
+        set(last_mnemonic "${CMAKE_MATCH_2}")
+        string(REGEX MATCHALL "[0-9a-f][0-9a-f]" raw_bytes "${raw}")
+        list(LENGTH raw_bytes count)
+        math(EXPR bytes_${current} "${bytes_${current}} + ${count}")
+        if(NOT last_mnemonic MATCHES "^(nop|xchg|data16|cs)")
+            math(EXPR insns_${current} "${insns_${current}} + 1")
+        endif()
+        if(last_mnemonic MATCHES "^call")
+            list(APPEND errors_${current} "call instruction")
+        endif()
+    elseif(line MATCHES "^ +[0-9a-f]+:\t([0-9a-f ]+)$")
+        string(REGEX MATCHALL "[0-9a-f][0-9a-f]" raw_bytes "${CMAKE_MATCH_1}")
+        list(LENGTH raw_bytes count)
+        math(EXPR bytes_${current} "${bytes_${current}} + ${count}")
+    elseif(line MATCHES "^\t+[0-9a-f]+: R_[A-Z0-9_]+\t([^ \t+-]+)")
+        set(symbol "${CMAKE_MATCH_1}")
+        if(symbol MATCHES "__cxa_")
+            list(APPEND errors_${current} "reference to ${symbol}")
+        elseif(last_mnemonic MATCHES "^jmp" AND NOT symbol MATCHES "^\\.text\\.unlikely")
+            list(APPEND errors_${current} "tail jump to ${symbol}")
+        endif()
+    endif()
+endforeach()
+
+set(failures 0)
+foreach(function IN LISTS functions)
+    if(NOT seen_${function})
+        message(SEND_ERROR "${function}: not found in object files")
+        math(EXPR failures "${failures} + 1")
+        continue()
+    endif()
+
+    list(APPEND errors_${function} ${cold_errors_${function}})
+    set(status "ok")
+    if(insns_${function} GREATER max_insns_${function})
+        list(APPEND errors_${function} "${insns_${function}} instructions exceed budget of ${max_insns_${function}}")
+    endif()
+    if(bytes_${function} GREATER max_bytes_${function})
+        list(APPEND errors_${function} "${bytes_${function}} bytes exceed budget of ${max_bytes_${function}}")
+    endif()
+    if(errors_${function})
+        set(status "FAILED")
+        math(EXPR failures "${failures} + 1")
+    endif()
+
+    message(STATUS "${function}: ${insns_${function}}/${max_insns_${function}} instructions, "
+                   "${bytes_${function}}/${max_bytes_${function}} bytes  ${status}")
+    foreach(error IN LISTS errors_${function})
+        message(STATUS "    ${error}")
+    endforeach()
+endforeach()
+
+if(failures GREATER 0)
+    message(FATAL_ERROR "${failures} function(s) exceed their codegen budget")
+endif()
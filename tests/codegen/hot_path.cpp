@@ -0,0 +1,89 @@
+/**
+ * @file hot_path.cpp
+ * @brief Representative hot-path functions checked by the codegen test.
+ *
+ * @details
+ * Each function is compiled at -O2 into its own section, disassembled and compared
+ * against tests/codegen/budgets_<arch>.txt by check_codegen.cmake. Functions have C
+ * linkage so the budget file can name them directly.
+ */
+#include <cstdint>
+
+#include "gpio_port.hpp"
+#include "gpio_pin.hpp"
+#include "gpio_wide_port.hpp"
+#include "mcu_type.hpp"
+
+extern "C" {
+
+void avr_port_set_bit(ss::GPIO_port<ss::AVR>& port, ss::AVR bit, bool high)
+{
+    port.setBit(bit, high);
+}
+
+void avr_port_set_bit3_high(ss::GPIO_port<ss::AVR>& port)
+{
+    port.setBit(3, true);
+}
+
+bool avr_port_read_bit(const ss::GPIO_port<ss::AVR>& port, ss::AVR bit)
+{
+    return port.readBit(bit);
+}
+
+void arm_port_set_bit(ss::GPIO_port<ss::ARM>& port, ss::ARM bit, bool high)
+{
+    port.setBit(bit, high);
+}
+
+void arm_port_set_bit31_low(ss::GPIO_port<ss::ARM>& port)
+{
+    port.setBit(31, false);
+}
+
+bool arm_port_read_bit(const ss::GPIO_port<ss::ARM>& port, ss::ARM bit)
+{
+    return port.readBit(bit);
+}
+
+bool arm_port_read_bit17(const ss::GPIO_port<ss::ARM>& port)
+{
+    return port.readBit(17);
+}
+
+void arm_port_set_bits(ss::GPIO_port<ss::ARM>& port, ss::ARM mask, ss::ARM values)
+{
+    port.setBits(mask, values);
+}
+
+void avr_pin_set_state(ss::GPIO_pin<ss::AVR>& pin, ss::GPIO::PinState state)
+{
+    pin.ss::GPIO_pin<ss::AVR>::setPinState(state);
+}
+
+bool avr_pin_read(const ss::GPIO_pin<ss::AVR>& pin)
+{
+    return pin.ss::GPIO_pin<ss::AVR>::read();
+}
+
+bool arm_pin_read(const ss::GPIO_pin<ss::ARM>& pin)
+{
+    return pin.ss::GPIO_pin<ss::ARM>::read();
+}
+
+void u64_port_set_bit(ss::GPIO_port<uint64_t>& port, uint64_t bit, bool high)
+{
+    port.setBit(bit, high);
+}
+
+void wide128_set_bits(ss::GPIO_wide_port<uint64_t, 2>& port, const ss::GPIO_wide_port<uint64_t, 2>::mask_t& mask, const ss::GPIO_wide_port<uint64_t, 2>::mask_t& values)
+{
+    port.setBits(mask, values);
+}
+
+void wide128_set_upper_byte(ss::GPIO_wide_port<uint64_t, 2>& port, const ss::GPIO_wide_port<uint64_t, 2>::mask_t& values)
+{
+    port.setBits<ss::GPIO_wide_port<uint64_t, 2>::mask_t{0, 0xFFull << 56}>(values);
+}
+
+}
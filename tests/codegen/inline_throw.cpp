@@ -0,0 +1,26 @@
+/**
+ * @file inline_throw.cpp
+ * @brief Negative case for the codegen test.
+ *
+ * @details
+ * Throws directly instead of through ss::detail::throwOutOfRange. The compiler moves
+ * the throw into the .cold part of the function, and check_codegen.cmake must still
+ * reject it. The CTest test passes only if the checker reports the __cxa_ reference.
+ */
+#include <stdexcept>
+
+#include "gpio_port.hpp"
+#include "mcu_type.hpp"
+
+extern "C" {
+
+void avr_port_set_bit_inline_throw(ss::GPIO_port<ss::AVR>& port, ss::AVR bit, bool high)
+{
+    if(bit > 7)
+    {
+        throw std::out_of_range("Pin out of range!");
+    }
+    port.setBits((ss::AVR)(1u << bit), high ? (ss::AVR)0xFF : (ss::AVR)0);
+}
+
+}
@@ -0,0 +1,131 @@
+#include <stdexcept>
+#include <system_error>
+#include <doctest/doctest.h>
+
+#include "gpio_chip.hpp"
+#include "gpio_chip_fake.hpp"
+#include "gpio_pin.hpp"
+#include "mcu_type.hpp"
+
+TEST_CASE("GPIO_chip: open failure")
+{
+    ss::GPIO_chip_fake_io io("/dev/gpiochip0", 8);
+    CHECK_THROWS_AS(ss::GPIO_chip(io, "/dev/gpiochip1"), std::system_error);
+}
+
+TEST_CASE("GPIO_chip_port<AVR>: wrong number of lines")
+{
+    ss::GPIO_chip_fake_io io("/dev/gpiochip0", 16);
+    ss::GPIO_chip chip(io, "/dev/gpiochip0");
+    CHECK_THROWS_AS(ss::GPIO_chip_port<ss::AVR>(chip, {0, 1, 2, 3, 4, 5, 6, 7, 8}), std::invalid_argument);
+}
+
+TEST_CASE("GPIO_chip_port<AVR>: line request is cached")
+{
+    ss::GPIO_chip_fake_io io("/dev/gpiochip0", 32);
+    ss::GPIO_chip chip(io, "/dev/gpiochip0");
+    ss::GPIO_chip_port<ss::AVR> portB(chip, {17, 18, 27, 22});
+    ss::GPIO_pin<ss::AVR> led(portB, 1);
+
+    led.setDirection(ss::OUTPUT);
+    portB.commit();
+    CHECK(io.callCount(GPIO_V2_GET_LINE_IOCTL) == 1);
+    CHECK(io.openRequests() == 1);
+    CHECK(io.isRequested(17));
+    CHECK(io.isOutput(18));
+    CHECK(!io.isOutput(17));
+
+    led.setPinState(ss::HIGH);
+    portB.commit();
+    led.setPinState(ss::LOW);
+    portB.commit();
+    CHECK(io.callCount(GPIO_V2_GET_LINE_IOCTL) == 1);
+    CHECK(io.callCount(GPIO_V2_LINE_SET_VALUES_IOCTL) == 2);
+    CHECK(!io.level(18));
+
+    io.resetCounters();
+    portB.commit();
+    CHECK(io.ioctlCount() == 0);
+}
+
+TEST_CASE("GPIO_chip_port<ARM>: port-wide write is one ioctl")
+{
+    ss::GPIO_chip_fake_io io("/dev/gpiochip0", 64);
+    ss::GPIO_chip chip(io, "/dev/gpiochip0");
+    ss::GPIO_chip_port<ss::ARM> portA(chip, {0, 1, 2, 3, 4, 5, 6, 7});
+    for(ss::ARM bit = 0; bit < 8; ++bit)
+    {
+        portA.setDirection(bit, true);
+    }
+    portA.commit();
+
+    io.resetCounters();
+    portA.setBits(0xFF, 0xA5);
+    portA.commit();
+    CHECK(io.ioctlCount() == 1);
+    CHECK(io.callCount(GPIO_V2_LINE_SET_VALUES_IOCTL) == 1);
+    CHECK(io.level(0));
+    CHECK(!io.level(1));
+    CHECK(io.level(7));
+}
+
+TEST_CASE("GPIO_chip_port<AVR>: direction and pull change reconfigure the request")
+{
+    ss::GPIO_chip_fake_io io("/dev/gpiochip0", 8);
+    ss::GPIO_chip chip(io, "/dev/gpiochip0");
+    ss::GPIO_chip_port<ss::AVR> portB(chip, {4, 5});
+    ss::GPIO_pin<ss::AVR> button(portB, 0);
+
+    button.init();
+    portB.commit();
+    button.setPinMode(ss::INPUT_PULLUP_MODE);
+    portB.commit();
+    CHECK(io.callCount(GPIO_V2_GET_LINE_IOCTL) == 1);
+    CHECK(io.callCount(GPIO_V2_LINE_SET_CONFIG_IOCTL) == 1);
+    CHECK(io.isPullUp(4));
+    CHECK(!io.isPullUp(5));
+
+    button.setPullMode(ss::NO_PULL);
+    portB.commit();
+    CHECK(io.callCount(GPIO_V2_LINE_SET_CONFIG_IOCTL) == 2);
+    CHECK(!io.isPullUp(4));
+
+    button.setPinMode(ss::INPUT_PULLUP_MODE);
+    portB.commit();
+    button.setDirection(ss::OUTPUT);
+    portB.commit();
+    CHECK(io.isOutput(4));
+    CHECK(!io.isPullUp(4));
+}
+
+TEST_CASE("GPIO_chip_port<AVR>: refresh reads inputs")
+{
+    ss::GPIO_chip_fake_io io("/dev/gpiochip0", 8);
+    ss::GPIO_chip chip(io, "/dev/gpiochip0");
+    ss::GPIO_chip_port<ss::AVR> portB(chip, {2, 3});
+    ss::GPIO_pin<ss::AVR> button(portB, 1);
+    button.init();
+
+    io.setExternal(3, true);
+    portB.sync();
+    CHECK(button.read());
+
+    io.setExternal(3, false);
+    portB.refresh();
+    CHECK(!button.read());
+    CHECK(io.callCount(GPIO_V2_LINE_GET_VALUES_IOCTL) == 2);
+}
+
+TEST_CASE("GPIO_chip_port<AVR>: line request released on destruction")
+{
+    ss::GPIO_chip_fake_io io("/dev/gpiochip0", 8);
+    ss::GPIO_chip chip(io, "/dev/gpiochip0");
+    {
+        ss::GPIO_chip_port<ss::AVR> portB(chip, {0, 1});
+        portB.commit();
+        CHECK(io.openRequests() == 1);
+
+        CHECK_THROWS_AS(ss::GPIO_chip_port<ss::AVR>(chip, {1}).commit(), std::system_error);
+    }
+    CHECK(io.openRequests() == 0);
+}
@@ -0,0 +1,126 @@
+#include <stdexcept>
+#include <type_traits>
+#include <doctest/doctest.h>
+
+#include "gpio_sim.hpp"
+#include "gpio_pin.hpp"
+#include "gpio_wide_port.hpp"
+#include "mcu_type.hpp"
+
+TEST_CASE("GPIO_sim<AVR>: pending writes applied once per tick")
+{
+    ss::GPIO_sim<ss::AVR> sim(1);
+    const std::size_t a = sim.addPort();
+    sim.port(a).setDirection(0, true);
+    sim.port(a).setDirection(1, true);
+
+    sim.addTask(a, [](ss::GPIO_sim<ss::AVR>::Port& port)
+    {
+        port.queueBits(0x03, 0x01);
+        port.queueBits(0x01, 0x00);
+        port.queueBits(0x02, 0x02);
+    });
+    sim.run(1);
+
+    CHECK(!sim.port(a).readBit(0));
+    CHECK(sim.port(a).readBit(1));
+    CHECK(sim.tick() == 1);
+}
+
+TEST_CASE("GPIO_sim<ARM>: wires across ports")
+{
+    ss::GPIO_sim<ss::ARM> sim(2);
+    const std::size_t a = sim.addPort();
+    const std::size_t b = sim.addPort();
+    ss::GPIO_pin<ss::ARM> out(sim.port(a), 3);
+    ss::GPIO_pin<ss::ARM> in(sim.port(b), 20);
+    out.setDirection(ss::OUTPUT);
+    in.init();
+    sim.connect(a, 3, b, 20);
+
+    out.setPinState(ss::HIGH);
+    sim.run(1);
+    CHECK(in.read());
+
+    out.setPinState(ss::LOW);
+    sim.run(1);
+    CHECK(!in.read());
+
+    in.setDirection(ss::OUTPUT);
+    out.setPinState(ss::HIGH);
+    sim.run(1);
+    CHECK(!in.read());
+
+    CHECK_THROWS_AS(sim.connect(a, 32, b, 0), std::out_of_range);
+}
+
+TEST_CASE("GPIO_sim<AVR>: result does not depend on thread count")
+{
+    auto simulate = [](std::size_t threads)
+    {
+        ss::GPIO_sim<ss::AVR> sim(threads);
+        const std::size_t count = 200;
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            sim.addPort();
+            sim.port(i).setDirection(0, true);
+        }
+        sim.addTask(0, [](ss::GPIO_sim<ss::AVR>::Port& port)
+        {
+            port.queueBits(0x01, port.readBit(0) ? 0x00 : 0x01);
+        });
+        for(std::size_t i = 1; i < count; ++i)
+        {
+            sim.connect(i - 1, 0, i, 1);
+            sim.addTask(i, [](ss::GPIO_sim<ss::AVR>::Port& port)
+            {
+                port.queueBits(0x01, port.readBit(1) ? 0x01 : 0x00);
+            });
+        }
+        sim.run(97);
+
+        unsigned result = 0;
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            result = result * 3 + sim.port(i).snapshot().pin;
+        }
+        return result;
+    };
+
+    const unsigned expected = simulate(1);
+    CHECK(simulate(3) == expected);
+    CHECK(simulate(8) == expected);
+}
+
+TEST_CASE("GPIO_sim<AVR>: task exception is rethrown")
+{
+    ss::GPIO_sim<ss::AVR> sim(2);
+    for(int i = 0; i < 100; ++i)
+    {
+        sim.addPort();
+    }
+    sim.addTask(42, [](ss::GPIO_sim<ss::AVR>::Port& port)
+    {
+        port.setBit(9, true);
+    });
+    CHECK_THROWS_AS(sim.run(5), std::out_of_range);
+    CHECK(sim.tick() == 5);
+}
+
+TEST_CASE("GPIO_sim<uint64_t>: wide port over simulated ports")
+{
+    ss::GPIO_sim<uint64_t> sim(1);
+    const std::size_t low = sim.addPort();
+    const std::size_t high = sim.addPort();
+
+    ss::GPIO_wide_port wide(sim.port(low), sim.port(high));
+    static_assert(std::is_same_v<decltype(wide), ss::GPIO_wide_port<uint64_t, 2>>);
+    ss::GPIO_wide_port<uint64_t, 2> explicitWide(sim.port(low), sim.port(high));
+
+    using mask_t = ss::GPIO_wide_port<uint64_t, 2>::mask_t;
+    wide.setDirectionBits(mask_t{1, 1ull << 63}, true);
+    explicitWide.setBits(mask_t{1, 1ull << 63}, mask_t{1, 1ull << 63});
+    CHECK(sim.port(low).readBit(0));
+    CHECK(sim.port(high).readBit(63));
+    CHECK(wide.readBit(127));
+}
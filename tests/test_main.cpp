@@ -4,6 +4,7 @@
 
 #include "gpio_port.hpp"
 #include "gpio_pin.hpp"
+#include "gpio_wide_port.hpp"
 #include "mcu_type.hpp"
 
 TEST_CASE("ConceptTest: McuType")
@@ -12,7 +13,9 @@ TEST_CASE("ConceptTest: McuType")
     static_assert(ss::McuType<uint32_t>);
     static_assert(ss::McuType<ss::AVR>);
     static_assert(ss::McuType<ss::ARM>);
-    static_assert(!ss::McuType<uint16_t>);
+    static_assert(ss::McuType<uint16_t>);
+    static_assert(ss::McuType<uint64_t>);
+    static_assert(!ss::McuType<int>);
     static_assert(ss::McuType<const volatile ss::AVR>);
 }
 
@@ -194,7 +197,154 @@ TEST_CASE("GPIO_pin<AVR>: read")
     CHECK(state == true);
 }
 
+TEST_CASE("GPIO_port<AVR>: snapshot and diff")
+{
+    volatile ss::AVR ddr=0x0F, port=0x03, pin=0x01;
+    ss::GPIO_port<ss::AVR> portB(ddr, port, pin);
+
+    const auto saved = portB.snapshot();
+    CHECK(saved.ddr == 0x0F);
+    CHECK(saved.port == 0x03);
+    CHECK(saved.pin == 0x01);
+    CHECK(!portB.diff(saved).any());
+
+    portB.setDirection(5, true);
+    portB.setBit(0, false);
+    const auto changed = portB.diff(saved);
+    CHECK(changed.ddr == (1<<5));
+    CHECK(changed.port == (1<<0));
+    CHECK(changed.pin == (1<<0));
+}
+
+TEST_CASE("GPIO_port<ARM>: restore")
+{
+    volatile ss::ARM ddr=0, port=0, pin=0;
+    ss::GPIO_port<ss::ARM> portA(ddr, port, pin);
+    portA.setDirection(31, true);
+    portA.setBit(31, true);
+    portA.pullUpBit(2, true);
+    const auto saved = portA.snapshot();
+
+    portA.setDirection(31, false);
+    portA.setDirection(2, true);
+    portA.setBit(7, true);
+    CHECK(portA.diff(saved).any());
+
+    portA.restore(saved);
+    CHECK(portA.snapshot() == saved);
+    CHECK(!portA.diff(saved).any());
+}
+
+TEST_CASE("GPIO_port<AVR>: restore writes only differing registers in glitch-safe order")
+{
+    using Port = ss::GPIO_port<ss::AVR>;
+    using Snapshot = Port::Snapshot;
+
+    // Replays a plan and checks every intermediate state against the glitch rules.
+    auto replay = [](const Snapshot& current, const Snapshot& saved)
+    {
+        const Port::RestorePlan plan = Port::planRestore(current, saved);
+        const ss::AVR toInput = current.ddr & ~saved.ddr;
+        const ss::AVR toOutput = ~current.ddr & saved.ddr;
+        Snapshot state = current;
+        for(std::size_t i = 0; i < plan.count; ++i)
+        {
+            const Port::RegisterWrite& write = plan.writes[i];
+            switch(write.reg)
+            {
+                case Port::Register::ddr:
+                    // A pin becoming output is only driven once PORT holds its saved level.
+                    CHECK(((write.value & toOutput) == 0 || ((state.port ^ saved.port) & write.value & toOutput) == 0));
+                    state.ddr = write.value;
+                    break;
+                case Port::Register::port:
+                    // A pin becoming input is released before its PORT bit changes.
+                    CHECK((state.ddr & toInput & (state.port ^ write.value)) == 0);
+                    state.port = write.value;
+                    break;
+                case Port::Register::pin:
+                    state.pin = write.value;
+                    break;
+            }
+        }
+        CHECK(state == saved);
+        return plan.count;
+    };
+
+    const Snapshot a{0xF0, 0x5A, 0x0F};
+    CHECK(replay(a, a) == 0);
+    CHECK(replay(a, Snapshot{0xF0, 0x5A, 0x00}) == 1);
+    CHECK(replay(a, Snapshot{0xF0, 0xA5, 0x0F}) == 1);
+    CHECK(replay(a, Snapshot{0x00, 0x00, 0x0F}) == 2);
+    CHECK(replay(a, Snapshot{0xFF, 0xFF, 0x0F}) == 2);
+    CHECK(replay(a, Snapshot{0x0F, 0xA5, 0xFF}) == 4);
+
+    volatile ss::AVR ddr=a.ddr, port=a.port, pin=a.pin;
+    Port portB(ddr, port, pin);
+    portB.restore(Snapshot{0x0F, 0xA5, 0xFF});
+    CHECK((portB.snapshot() == Snapshot{0x0F, 0xA5, 0xFF}));
+}
 
+TEST_CASE("GPIO_port<uint16_t>: validate bit test")
+{
+    volatile uint16_t ddr=0, port=0, pin=0;
+    ss::GPIO_port<uint16_t> portC(ddr, port, pin);
+
+    CHECK(portC.validateBit(0));
+    CHECK(portC.validateBit(15));
+    CHECK_THROWS_AS(portC.validateBit(16), std::out_of_range);
+}
 
+TEST_CASE("GPIO_port<uint64_t>: setBit test")
+{
+    volatile uint64_t ddr=0, port=0, pin=0;
+    ss::GPIO_port<uint64_t> portD(ddr, port, pin);
+
+    CHECK(portD.validateBit(63));
+    CHECK_THROWS_AS(portD.validateBit(64), std::out_of_range);
 
+    portD.setDirection(63, true);
+    portD.setBit(63, true);
+    CHECK(ddr == (uint64_t)1 << 63);
+    CHECK(port == (uint64_t)1 << 63);
+    CHECK(portD.readBit(63));
+}
 
+TEST_CASE("GPIO_wide_port<ARM>: 64-bit port from two ports")
+{
+    volatile ss::ARM ddr0=0, port0=0, pin0=0, ddr1=0, port1=0, pin1=0;
+    ss::GPIO_port<ss::ARM> portA(ddr0, port0, pin0);
+    ss::GPIO_port<ss::ARM> portB(ddr1, port1, pin1);
+    ss::GPIO_wide_port wide(portA, portB);
+    static_assert(decltype(wide)::width == 64);
+
+    wide.setDirection(40, true);
+    CHECK(ddr1 == (1u << 8));
+    wide.setBit(40, true);
+    CHECK(wide.readBit(40));
+    CHECK(!wide.readBit(8));
+    CHECK_THROWS_AS(wide.setBit(64, true), std::out_of_range);
+
+    CHECK((decltype(wide)::bitMask(33) == decltype(wide)::mask_t{0, 2}));
+}
+
+TEST_CASE("GPIO_wide_port<uint64_t>: 128-bit mask operations")
+{
+    volatile uint64_t ddr0=0, port0=0, pin0=0, ddr1=0, port1=0, pin1=0;
+    ss::GPIO_port<uint64_t> low(ddr0, port0, pin0);
+    ss::GPIO_port<uint64_t> high(ddr1, port1, pin1);
+    ss::GPIO_wide_port<uint64_t, 2> wide(low, high);
+    using mask_t = ss::GPIO_wide_port<uint64_t, 2>::mask_t;
+
+    wide.setDirectionBits(mask_t{~0ull, ~0ull}, true);
+    wide.setBits(mask_t{0xFF, 0xF0ull << 56}, mask_t{0x0F, ~0ull});
+    CHECK(port0 == 0x0F);
+    CHECK(port1 == 0xF0ull << 56);
+    CHECK((wide.readBits(mask_t{~0ull, ~0ull}) == mask_t{0x0F, 0xF0ull << 56}));
+
+    constexpr mask_t upperOnly{0, 1};
+    wide.setBits<upperOnly>(mask_t{~0ull, ~0ull});
+    CHECK(port0 == 0x0F);
+    CHECK(port1 == ((0xF0ull << 56) | 1));
+    CHECK((wide.readBits<upperOnly>() == mask_t{0, 1}));
+}